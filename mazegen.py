@@ -0,0 +1,132 @@
+import ctypes
+import os
+
+import numpy as np
+
+ABI_VERSION = 2
+
+_lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)), "libmazegen.so"))
+
+_lib.mazegen_abi_version.restype = ctypes.c_int
+_lib.mazegen_seed.argtypes = [ctypes.c_uint]
+_lib.mazegen_init.argtypes = [ctypes.c_int, ctypes.c_int]
+_lib.mazegen_init.restype = ctypes.c_void_p
+_lib.mazegen_load_bmp.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_int)]
+_lib.mazegen_load_bmp.restype = ctypes.c_void_p
+_lib.mazegen_generate.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+_lib.mazegen_generate.restype = ctypes.c_int
+_lib.mazegen_width.argtypes = [ctypes.c_void_p]
+_lib.mazegen_height.argtypes = [ctypes.c_void_p]
+_lib.mazegen_cells.argtypes = [ctypes.c_void_p]
+_lib.mazegen_cells.restype = ctypes.c_void_p
+_lib.mazegen_render.argtypes = [ctypes.c_void_p, ctypes.c_int]
+_lib.mazegen_render.restype = ctypes.c_void_p
+_lib.mazegen_pixels_width.argtypes = [ctypes.c_void_p]
+_lib.mazegen_pixels_height.argtypes = [ctypes.c_void_p]
+_lib.mazegen_pixel_data.argtypes = [ctypes.c_void_p]
+_lib.mazegen_pixel_data.restype = ctypes.c_void_p
+_lib.mazegen_save_bmp.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+_lib.mazegen_solve.argtypes = [ctypes.c_void_p] + [ctypes.c_int] * 4 + [ctypes.c_void_p]
+_lib.mazegen_solve.restype = ctypes.c_int
+_lib.mazegen_free_pixels.argtypes = [ctypes.c_void_p]
+_lib.mazegen_free.argtypes = [ctypes.c_void_p]
+
+if _lib.mazegen_abi_version() != ABI_VERSION:
+    raise ImportError("libmazegen.so has an unsupported abi version")
+
+CELL_SIZE = _lib.mazegen_cell_size()
+WALLS_OFFSET = _lib.mazegen_walls_offset()
+
+TOP, LEFT, RIGHT, BOTTOM = range(4)
+
+
+def _view(address, shape, owner):
+    """Wraps memory owned by the library as a uint8 array without copying.
+    The array keeps owner alive, so the memory is not freed while it is used."""
+    buf = (ctypes.c_uint8 * int(np.prod(shape))).from_address(address)
+    buf._owner = owner
+    return np.frombuffer(buf, dtype=np.uint8).reshape(shape)
+
+
+class Pixels:
+    _ptr = None
+
+    def __init__(self, maze, block_size):
+        ptr = _lib.mazegen_render(maze._ptr, block_size)
+        if ptr is None:
+            raise ValueError(f"Invalid block size: {block_size}")
+        self._ptr = ptr
+        self.width = _lib.mazegen_pixels_width(self._ptr)
+        self.height = _lib.mazegen_pixels_height(self._ptr)
+
+    def array(self):
+        """The pixels as a (height, width, 4) RGBA array sharing memory with the library."""
+        return _view(_lib.mazegen_pixel_data(self._ptr), (self.height, self.width, 4), self)
+
+    def save_bmp(self, path):
+        if _lib.mazegen_save_bmp(self._ptr, os.fsencode(path)) != 0:
+            raise OSError(f"Could not open file: '{path}'")
+
+    def __del__(self):
+        if self._ptr is not None:
+            _lib.mazegen_free_pixels(self._ptr)
+
+
+class Maze:
+    _ptr = None
+
+    def __init__(self, width, height, seed=None):
+        if seed is not None:
+            _lib.mazegen_seed(seed)
+        ptr = _lib.mazegen_init(width, height)
+        if ptr is None:
+            raise ValueError(f"Invalid maze size: {width}x{height}")
+        self._set_ptr(ptr)
+
+    @classmethod
+    def from_bmp(cls, path):
+        """Reads a maze from a bmp file made by maze-gen, returns the maze and the block size of the picture."""
+        block_size = ctypes.c_int()
+        ptr = _lib.mazegen_load_bmp(os.fsencode(path), ctypes.byref(block_size))
+        if ptr is None:
+            raise ValueError(f"Could not read maze from file: '{path}'")
+        maze = cls.__new__(cls)
+        maze._set_ptr(ptr)
+        return maze, block_size.value
+
+    def _set_ptr(self, ptr):
+        self._ptr = ptr
+        self.width = _lib.mazegen_width(self._ptr)
+        self.height = _lib.mazegen_height(self._ptr)
+
+    def generate(self, start=(0, 0)):
+        if _lib.mazegen_generate(self._ptr, start[0], start[1]) != 0:
+            raise IndexError(f"Start {tuple(start)} is outside of the maze")
+        return self
+
+    def walls(self):
+        """The walls as a (height, width, 4) bool array sharing memory with the library,
+        the last axis is indexed with TOP, LEFT, RIGHT and BOTTOM."""
+        cells = _view(_lib.mazegen_cells(self._ptr), (self.height, self.width, CELL_SIZE), self)
+        return cells[:, :, WALLS_OFFSET : WALLS_OFFSET + 4].view(np.bool_)
+
+    def render(self, block_size):
+        return Pixels(self, block_size)
+
+    def solve(self, start, stop):
+        """The shortest path from start to stop as an (n, 2) array of (x, y) cells, empty if there is none."""
+        path = np.empty(self.width * self.height, dtype=np.intc)
+        n = _lib.mazegen_solve(self._ptr, start[0], start[1], stop[0], stop[1], path.ctypes.data)
+        if n < 0:
+            raise IndexError(f"Start {tuple(start)} or stop {tuple(stop)} is outside of the maze")
+        return np.stack((path[:n] % self.width, path[:n] // self.width), axis=1)
+
+    def __del__(self):
+        if self._ptr is not None:
+            _lib.mazegen_free(self._ptr)
+
+
+if __name__ == "__main__":
+    maze = Maze(10, 10).generate()
+    path = maze.solve((0, 0), (maze.width - 1, maze.height - 1))
+    print(f"The path through the maze is {len(path)} cells long")
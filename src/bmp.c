@@ -1,8 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "bmp.h"
 #include "util.h"
 #include <assert.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 int get_image_size(const BMPHeader *header) {
     return header->width * header->height * header->bytes_per_pixel;
@@ -38,6 +44,161 @@ void bmp_header_to_bytes(unsigned char header_bytes[BMP_HEADER_SIZE],
     write_bytes(&header_bytes[34], image_size, 4);                  // This is the size of the raw bitmap data
 }
 
+static unsigned int read_bytes(const unsigned char bytes[], size_t len) {
+    unsigned int val = 0;
+    for (size_t i = 0; i < len; i++) {
+        val |= (unsigned int)bytes[i] << 8 * i;
+    }
+    return val;
+}
+
+/**
+ * @brief Reads back a header written by bmp_header_to_bytes
+ * 
+ * @param header_bytes The first BMP_HEADER_SIZE bytes of the file
+ * @param header Where the header is stored
+ * @return true The header is one this program writes: 32 bits per pixel, bottom-up and not compressed
+ * @return false The header is different
+ */
+bool bmp_header_from_bytes(const unsigned char header_bytes[BMP_HEADER_SIZE], BMPHeader *header) {
+    if (header_bytes[0] != 'B' || header_bytes[1] != 'M')
+        return false;
+
+    if (read_bytes(&header_bytes[10], 4) != BMP_HEADER_SIZE ||   // Starting address of pixel array
+        read_bytes(&header_bytes[14], 4) != INFO_HEADER_SIZE ||  // The size of info header
+        read_bytes(&header_bytes[26], 2) != 1 ||                 // Number of color planes
+        read_bytes(&header_bytes[28], 2) != 32 ||                // The number of bits per pixel
+        read_bytes(&header_bytes[30], 4) != 0)                   // No compression
+        return false;
+
+    unsigned int width = read_bytes(&header_bytes[18], 4),
+                 height = read_bytes(&header_bytes[22], 4);
+    // negative heights (top-down images) are never written, and the size has to fit in an int
+    if (width == 0 || height == 0 || 0x7fffffff / 4 / width < height)
+        return false;
+
+    header->width = width;
+    header->height = height;
+    header->bytes_per_pixel = 4;
+
+    int image_size = get_image_size(header);
+    if (read_bytes(&header_bytes[2], 4) != (unsigned int)(BMP_HEADER_SIZE + image_size) || // The size of the bmp file in bytes
+        read_bytes(&header_bytes[34], 4) != (unsigned int)image_size)                      // This is the size of the raw bitmap data
+        return false;
+
+    return true;
+}
+
+/**
+ * @brief Maps a bmp file written by this program into memory and checks its header.
+ * The pixels are read straight from the mapping, nothing is copied.
+ * 
+ * @param path Path to the bmp file
+ * @param bmp Where the file is stored, it has to be closed with close_bmp_file on success
+ * @return BMPErrors BMP_NO_ERROR on success
+ */
+BMPErrors open_bmp_file(const char *path, BMPFile *bmp) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return BMP_ERROR_OPEN;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return BMP_ERROR_OPEN;
+    }
+
+    if (st.st_size < BMP_HEADER_SIZE) {
+        close(fd);
+        return BMP_ERROR_TRUNCATED;
+    }
+
+    void *bytes = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the file is closed
+    close(fd);
+    if (bytes == MAP_FAILED)
+        return BMP_ERROR_MAP;
+
+    bmp->bytes = bytes;
+    bmp->size = st.st_size;
+
+    if (bmp_header_from_bytes(bmp->bytes, &bmp->header) == false) {
+        close_bmp_file(bmp);
+        return BMP_ERROR_INVALID_HEADER;
+    }
+
+    if (bmp->size < (size_t)BMP_HEADER_SIZE + get_image_size(&bmp->header)) {
+        close_bmp_file(bmp);
+        return BMP_ERROR_TRUNCATED;
+    }
+
+    return BMP_NO_ERROR;
+}
+
+/**
+ * @brief Reads a pixel of an opened bmp file
+ * 
+ * @param bmp The opened bmp file
+ * @param x The column of the pixel
+ * @param y The row of the pixel, 0 is the top row
+ * @return Pixel The pixel
+ */
+Pixel get_bmp_pixel(const BMPFile *bmp, int x, int y) {
+    assert(0 <= x && x < bmp->header.width);
+    assert(0 <= y && y < bmp->header.height);
+
+    // the rows are stored bottom-up
+    const unsigned char *p = bmp->bytes + BMP_HEADER_SIZE +
+                             ((size_t)(bmp->header.height - y - 1) * bmp->header.width + x) * 4;
+    Pixel pixel = {.r = p[2], .g = p[1], .b = p[0], .a = p[3]};
+    return pixel;
+}
+
+void close_bmp_file(BMPFile *bmp) {
+    munmap((void *)bmp->bytes, bmp->size);
+    bmp->bytes = NULL;
+    bmp->size = 0;
+}
+
+const char *bmp_error_to_str(BMPErrors error) {
+    switch (error) {
+        case BMP_NO_ERROR:
+            return "There were no errors";
+
+        case BMP_ERROR_OPEN:
+            return "Could not open file";
+
+        case BMP_ERROR_MAP:
+            return "Could not map file into memory";
+
+        case BMP_ERROR_INVALID_HEADER:
+            return "The file is not a 32 bit bmp file";
+
+        case BMP_ERROR_TRUNCATED:
+            return "The file is shorter than its header says";
+
+        default:
+            assert(0 && "Unhandled error type");
+            return "";
+    }
+}
+
+/**
+ * @brief Converts a line of pixels to the byte layout of the bmp pixel array
+ * 
+ * @param bytes Has to hold width * 4 bytes
+ * @param line The line of pixels
+ * @param width Width of the line
+ */
+void pixel_line_to_bytes(unsigned char *bytes, const Pixel *line, int width) {
+    for (int col = 0; col < width; col++) {
+        bytes[col * 4 + 3] = line[col].a; // alpha
+        bytes[col * 4 + 2] = line[col].r; // red
+        bytes[col * 4 + 1] = line[col].g; // green
+        bytes[col * 4 + 0] = line[col].b; // blue
+    }
+}
+
 /**
  * @brief Write pixels to bmp file
  * 
@@ -61,13 +222,7 @@ void create_image_from_pixels(FILE *fp, Pixel **pixels, int width, int height) {
     check_malloc(pixel_array);
 
     for (int row = 0; row < height; row++) {
-        for (int col = 0; col < width; col++) {
-            int p = ((height - row - 1) * width + col) * 4;
-            pixel_array[p + 3] = pixels[row][col].a; // alpha
-            pixel_array[p + 2] = pixels[row][col].r; // red
-            pixel_array[p + 1] = pixels[row][col].g; //green
-            pixel_array[p + 0] = pixels[row][col].b; //blue
-        }
+        pixel_line_to_bytes(&pixel_array[(height - row - 1) * width * 4], pixels[row], width);
     }
 
     fwrite(header_bytes, 1, BMP_HEADER_SIZE, fp);
@@ -1,6 +1,7 @@
 #ifndef BMP_H
 #define BMP_H
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -19,10 +20,37 @@ typedef struct BMPHeader {
     short int bytes_per_pixel; /* The number of bytes per pixel, which is the color depth of the image [2 bytes] */
 } BMPHeader;
 
+typedef enum BMPErrors {
+    BMP_NO_ERROR = 0,
+    BMP_ERROR_OPEN,
+    BMP_ERROR_MAP,
+    BMP_ERROR_INVALID_HEADER,
+    BMP_ERROR_TRUNCATED,
+    BMP_ERROR_COUNT
+} BMPErrors;
+
+typedef struct BMPFile {
+    BMPHeader header;
+    const unsigned char *bytes; /* The whole file mapped into memory */
+    size_t size;                /* The size of the file in bytes */
+} BMPFile;
+
 int get_image_size(const BMPHeader *header);
 
 void bmp_header_to_bytes(unsigned char header_bytes[BMP_HEADER_SIZE], const BMPHeader *header);
 
+void pixel_line_to_bytes(unsigned char *bytes, const Pixel *line, int width);
+
+bool bmp_header_from_bytes(const unsigned char header_bytes[BMP_HEADER_SIZE], BMPHeader *header);
+
+BMPErrors open_bmp_file(const char *path, BMPFile *bmp);
+
+Pixel get_bmp_pixel(const BMPFile *bmp, int x, int y);
+
+void close_bmp_file(BMPFile *bmp);
+
+const char *bmp_error_to_str(BMPErrors error);
+
 void create_image_from_pixels(FILE *fp, Pixel **pixels, int width, int height);
 
 Pixel **init_pixel_array(int width, int height);
@@ -1,5 +1,9 @@
 #include "bmp.h"
 #include "maze.h"
+#include "pipeline.h"
+#include "svg.h"
+#include "util.h"
+#include "verify.h"
 #include <assert.h>
 #include <errno.h>
 #include <stdio.h>
@@ -7,16 +11,72 @@
 #include <string.h>
 #include <time.h>
 
-#define FLAG_CAP 5
+#define FLAG_CAP 8
 #include "flags.h"
 
+/**
+ * @brief Checks that the maze is perfect and exits with failure if it is not
+ * 
+ * @param m The maze to check
+ */
+static void verify_maze_or_exit(const Maze *m) {
+    MazeVerification v;
+    if (verify_maze(m, &v) == false) {
+        fprintf(stderr, "ERROR: The maze is not perfect: ");
+        print_maze_verification(stderr, &v);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(stdout, "Maze is perfect: ");
+    print_maze_verification(stdout, &v);
+}
+
+/**
+ * @brief Loads the maze from a bmp file made by this program,
+ * or generates a new one if there is no file
+ * 
+ * @param in_path Path to the bmp file, can be NULL
+ * @param width The width of the generated maze
+ * @param height The height of the generated maze
+ * @return Maze* The maze
+ */
+static Maze *load_or_generate_maze(const char *in_path, int width, int height) {
+    if (in_path == NULL) {
+        Maze *m = init_maze(width, height);
+        generate_maze(m, 0, 0);
+        return m;
+    }
+
+    BMPFile bmp;
+    BMPErrors error = open_bmp_file(in_path, &bmp);
+    if (error != BMP_NO_ERROR) {
+        fprintf(stderr, "ERROR: %s: '%s'\n", bmp_error_to_str(error), in_path);
+        exit(EXIT_FAILURE);
+    }
+
+    Maze *m = maze_from_bmp(&bmp, NULL);
+    close_bmp_file(&bmp);
+    if (m == NULL) {
+        fprintf(stderr, "ERROR: The file does not contain a maze: '%s'\n", in_path);
+        exit(EXIT_FAILURE);
+    }
+
+    return m;
+}
+
 int main(int argc, char *argv[]) {
     int *width = new_int_flag("mw", 10, "The width of the maze");
     int *height = new_int_flag("mh", 10, "The height of the maze");
 
     int *block_size = new_int_flag("bs", 10, "The size of a square in the maze in pixels");
 
-    char **out_path = new_str_flag("o", NULL, "Path to the output bmp file. If this is set it will output a picture into the specified file.");
+    char **out_path = new_str_flag("o", NULL, "Path to the output bmp, svg or txt file. If this is set it will output a picture, or a list of wall segments for txt, into the specified file.");
+
+    char **in_path = new_str_flag("i", NULL, "Path to a bmp file made by this program. If this is set the maze is read from the file instead of generated.");
+
+    bool *pipelined = new_bool_flag("p", false, "Renders and writes the bmp file at the same time, the writing is done by a background thread.");
+
+    bool *verify = new_bool_flag("verify", false, "Checks that the generated maze is perfect (connected and without loops) before outputting it.");
 
     bool *help = new_bool_flag("h", false, "Prints out this help message and exits with 0");
 
@@ -39,50 +99,72 @@ int main(int argc, char *argv[]) {
 
     if (*out_path == NULL) {
         // print maze to console
-        Maze *m = init_maze(*width, *height);
-        generate_maze(m, 0, 0);
+        Maze *m = load_or_generate_maze(*in_path, *width, *height);
 
         print_maze(stdout, m);
 
+        if (*verify == true)
+            verify_maze_or_exit(m);
+
         free_maze(m);
     } else {
 
-        // check if out_path is bmp file
-        if (strstr(*out_path, ".bmp") == NULL) {
-            fprintf(stderr, "ERROR: The file is not a bmp file: '%s'", *out_path);
+        bool is_svg = strstr(*out_path, ".svg") != NULL,
+             is_txt = strstr(*out_path, ".txt") != NULL;
+
+        // check if out_path is a supported file
+        if (strstr(*out_path, ".bmp") == NULL && is_svg == false && is_txt == false) {
+            fprintf(stderr, "ERROR: The file is not a bmp, svg or txt file: '%s'", *out_path);
             exit(EXIT_FAILURE);
         }
 
-        clock_t start = clock();
+        double start = get_time();
 
-        Maze *m = init_maze(*width, *height);
-        generate_maze(m, 0, 0);
+        Maze *m = load_or_generate_maze(*in_path, *width, *height);
+
+        if (*verify == true)
+            verify_maze_or_exit(m);
 
-        // draw maze to bmp file
+        // draw maze to file
         FILE *fp = fopen(*out_path, "wb");
         if (fp == NULL) {
             fprintf(stderr, "ERROR: Could not open file: '%s'", strerror(errno));
             exit(EXIT_FAILURE);
         }
 
-        Pixel **pixels = gen_pixel_arr_from_maze(m, *block_size);
-
-        create_image_from_pixels(fp, pixels,
-                                 get_maze_width_in_pixels(m->width, *block_size),
-                                 get_maze_height_in_pixels(m->height, *block_size));
+        PipelineStats stats;
+        if (is_svg == true) {
+            create_svg_from_maze(fp, m, *block_size);
+        } else if (is_txt == true) {
+            create_lines_from_maze(fp, m);
+        } else if (*pipelined == true) {
+            create_image_from_maze_pipelined(fp, m, *block_size, &stats);
+        } else {
+            Pixel **pixels = gen_pixel_arr_from_maze(m, *block_size);
+
+            create_image_from_pixels(fp, pixels,
+                                     get_maze_width_in_pixels(m->width, *block_size),
+                                     get_maze_height_in_pixels(m->height, *block_size));
+            free_pixel_array(pixels);
+        }
         size_t file_size = ftell(fp);
 
         fclose(fp);
-        free_pixel_array(pixels);
         free_maze(m);
 
-        clock_t end = clock();
-        double duration = (double)(end - start) / CLOCKS_PER_SEC;
+        double duration = get_time() - start;
 
-        fprintf(stdout, "Successfully generated maze at: '%s' (%fs, %g MB)\n",
+        fprintf(stdout, "Successfully generated maze at: '%s' (%fs, %g MB",
                 *out_path,
                 duration,
                 file_size / (1000.0 * 1000.0));
+        if (*pipelined == true && is_svg == false && is_txt == false) {
+            fprintf(stdout, ", render %fs, write %fs, %.1f%% overlap",
+                    stats.render_time,
+                    stats.write_time,
+                    get_overlap_efficiency(&stats) * 100);
+        }
+        fprintf(stdout, ")\n");
     }
 
     return 0;
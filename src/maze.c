@@ -72,6 +72,128 @@ Pixel **gen_pixel_arr_from_maze(const Maze *m, int block_size) {
     return pixels;
 }
 
+/**
+ * @brief Renders a single row of the maze grid into a line of pixels.
+ * The grid is (2 * height + 1) rows tall, every row is block_size pixels
+ * high and every pixel row of it looks the same, so one line is enough.
+ * It produces the same picture as gen_pixel_arr_from_maze.
+ *
+ * @param m The maze to render
+ * @param grid_row The row of the grid, 0 <= grid_row < 2 * height + 1
+ * @param block_size The size of a square in the maze in pixels
+ * @param line Has to hold get_maze_width_in_pixels(m->width, block_size) pixels
+ */
+void gen_pixel_row_from_maze(const Maze *m, int grid_row, int block_size, Pixel *line) {
+    assert(block_size > 0);
+    assert(0 <= grid_row && grid_row < 2 * m->height + 1);
+
+    Pixel wall = {.r = 0, .g = 0, .b = 0, .a = 255};        // black
+    Pixel space = {.r = 255, .g = 255, .b = 255, .a = 255}; // white
+
+    int grid_width = 2 * m->width + 1;
+    int y = grid_row / 2;
+
+    for (int grid_col = 0; grid_col < grid_width; grid_col++) {
+        int x = grid_col / 2;
+        bool is_wall;
+
+        if (grid_row % 2 == 0 && grid_col % 2 == 0) {
+            // diagonal corner
+            is_wall = true;
+        } else if (grid_row % 2 == 0) {
+            // horizontal wall, the cell below draws it last if there is one
+            is_wall = y < m->height ? m->cells[y][x].walls[TOP]
+                                    : m->cells[y - 1][x].walls[BOTTOM];
+        } else if (grid_col % 2 == 0) {
+            // vertical wall, the cell on the right draws it last if there is one
+            is_wall = x < m->width ? m->cells[y][x].walls[LEFT]
+                                   : m->cells[y][x - 1].walls[RIGHT];
+        } else {
+            is_wall = false;
+        }
+
+        Pixel p = is_wall ? wall : space;
+        for (int i = 0; i < block_size; i++)
+            line[grid_col * block_size + i] = p;
+    }
+}
+
+static bool is_wall_pixel(Pixel p) {
+    return p.r + p.g + p.b < 3 * 128;
+}
+
+/**
+ * @brief Rebuilds a maze from a bmp file drawn by gen_pixel_arr_from_maze.
+ * The block size is the length of the wall in the top-left corner, after
+ * that one pixel is read for every wall, cell and corner. Every corner has to be
+ * a wall and every cell has to be space, otherwise it is not a maze.
+ * 
+ * @param bmp The opened bmp file
+ * @param block_size If not NULL the detected block size is stored in it
+ * @return Maze* The maze, NULL if the picture does not look like a maze
+ */
+Maze *maze_from_bmp(const BMPFile *bmp, int *block_size) {
+    int width = bmp->header.width, height = bmp->header.height;
+
+    // the corner is a wall and the first cell is space, so walk the diagonal until it ends
+    int bs = 0;
+    while (bs < width && bs < height && is_wall_pixel(get_bmp_pixel(bmp, bs, bs)))
+        bs++;
+
+    if (bs == 0 || width % bs != 0 || height % bs != 0 ||
+        (width / bs) % 2 == 0 || (height / bs) % 2 == 0 ||
+        width / bs < 3 || height / bs < 3)
+        return NULL;
+
+    Maze *m = init_maze((width / bs - 1) / 2, (height / bs - 1) / 2);
+    bool is_maze = true;
+
+    for (int y = 0; y <= m->height && is_maze; y++) {
+        // top-left pixel of the cell
+        int y_in_pixels = (2 * y + 1) * bs;
+
+        for (int x = 0; x <= m->width && is_maze; x++) {
+            int x_in_pixels = (2 * x + 1) * bs;
+
+            // top-left corner of the cell, the last row and column only have corners
+            if (is_wall_pixel(get_bmp_pixel(bmp, x_in_pixels - bs, y_in_pixels - bs)) == false)
+                is_maze = false;
+
+            // the wall above and on the left of the cell, the last row and column
+            // only have the one which closes the maze from the bottom and the right
+            bool top = x < m->width && is_wall_pixel(get_bmp_pixel(bmp, x_in_pixels, y_in_pixels - bs)),
+                 left = y < m->height && is_wall_pixel(get_bmp_pixel(bmp, x_in_pixels - bs, y_in_pixels));
+
+            // every wall is shared with the neighbour on the other side of it
+            if (x < m->width && 0 < y)
+                m->cells[y - 1][x].walls[BOTTOM] = top;
+            if (y < m->height && 0 < x)
+                m->cells[y][x - 1].walls[RIGHT] = left;
+
+            if (x == m->width || y == m->height)
+                continue;
+
+            if (is_wall_pixel(get_bmp_pixel(bmp, x_in_pixels, y_in_pixels)))
+                is_maze = false;
+
+            Cell *cell = &m->cells[y][x];
+            cell->is_visited = true;
+            cell->walls[TOP] = top;
+            cell->walls[LEFT] = left;
+        }
+    }
+
+    if (is_maze == false) {
+        free_maze(m);
+        return NULL;
+    }
+
+    if (block_size != NULL)
+        *block_size = bs;
+
+    return m;
+}
+
 void generate_maze(Maze *m, int start_x, int start_y) {
     assert(0 <= start_y && start_y < m->height);
     assert(0 <= start_x && start_x < m->width);
@@ -100,6 +222,76 @@ void generate_maze(Maze *m, int start_x, int start_y) {
     }
 }
 
+/**
+ * @brief Finds the shortest path between two cells with a breadth-first search
+ * 
+ * @param m The maze
+ * @param start_x The x coordinate of the first cell of the path
+ * @param start_y The y coordinate of the first cell of the path
+ * @param end_x The x coordinate of the last cell of the path
+ * @param end_y The y coordinate of the last cell of the path
+ * @param path Has to hold width * height ints, the cells of the path
+ * are stored in it as y * width + x from start to end
+ * @return int The number of cells in the path, 0 if end can not be reached
+ */
+int solve_maze(const Maze *m, int start_x, int start_y, int end_x, int end_y, int *path) {
+    assert(0 <= start_y && start_y < m->height);
+    assert(0 <= start_x && start_x < m->width);
+    assert(0 <= end_y && end_y < m->height);
+    assert(0 <= end_x && end_x < m->width);
+
+    int cell_count = m->width * m->height;
+    int start = start_y * m->width + start_x, end = end_y * m->width + end_x;
+
+    // the cell we came from for each visited cell, -1 if not visited
+    int *prev = malloc(cell_count * sizeof(int));
+    check_malloc(prev);
+    for (int i = 0; i < cell_count; i++)
+        prev[i] = -1;
+
+    // path doubles as the queue, it is only filled with the result at the end
+    int head = 0, tail = 0;
+    path[tail++] = start;
+    prev[start] = start;
+
+    while (head < tail && prev[end] == -1) {
+        int cell = path[head++];
+        int x = cell % m->width, y = cell / m->width;
+
+        for (int dir = TOP; dir < DIRECTION_COUNT; dir++) {
+            if (m->cells[y][x].walls[dir])
+                continue;
+
+            int move_x = x + MOVES[dir][0], move_y = y + MOVES[dir][1];
+            if (move_x < 0 || m->width <= move_x || move_y < 0 || m->height <= move_y)
+                continue;
+
+            int next = move_y * m->width + move_x;
+            if (prev[next] == -1) {
+                prev[next] = cell;
+                path[tail++] = next;
+            }
+        }
+    }
+
+    int length = 0;
+    if (prev[end] != -1) {
+        for (int cell = end; cell != start; cell = prev[cell])
+            length++;
+        length++;
+
+        // walk back from end and fill path from the back
+        int i = length - 1;
+        for (int cell = end; cell != start; cell = prev[cell])
+            path[i--] = cell;
+        path[0] = start;
+    }
+
+    free(prev);
+
+    return length;
+}
+
 Maze *init_maze(int width, int height) {
     assert(0 < width && 0 < height);
     Maze *m = malloc(sizeof(Maze));
@@ -32,10 +32,16 @@ int get_maze_height_in_pixels(int height, int block_size);
 
 Pixel **gen_pixel_arr_from_maze(const Maze *m, int block_size);
 
+void gen_pixel_row_from_maze(const Maze *m, int grid_row, int block_size, Pixel *line);
+
 Maze *init_maze(int width, int height);
 
+Maze *maze_from_bmp(const BMPFile *bmp, int *block_size);
+
 void generate_maze(Maze *m, int start_x, int start_y);
 
+int solve_maze(const Maze *m, int start_x, int start_y, int end_x, int end_y, int *path);
+
 void clear_maze(Maze *m);
 
 void print_maze(FILE *out, Maze *m);
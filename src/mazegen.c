@@ -0,0 +1,206 @@
+#include "mazegen.h"
+#include "bmp.h"
+#include "maze.h"
+#include "util.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct MazegenPixels {
+    Pixel **pixels;
+    int width, height; /* The size of the image in pixels */
+} MazegenPixels;
+
+/*
+ * Unlike the rest of the program the library checks its arguments instead of
+ * asserting them, a wrong argument from the caller returns an error.
+ */
+
+static bool is_in_maze(const Maze *m, int x, int y) {
+    return 0 <= x && x < m->width && 0 <= y && y < m->height;
+}
+
+int mazegen_abi_version(void) {
+    return MAZEGEN_ABI_VERSION;
+}
+
+/**
+ * @brief Seeds the random generator used by mazegen_generate
+ * 
+ * @param seed The seed
+ */
+void mazegen_seed(unsigned int seed) {
+    srand(seed);
+}
+
+/**
+ * @brief Allocates a maze where every cell has all four walls,
+ * it has to be freed with mazegen_free
+ * 
+ * @param width The width of the maze in cells
+ * @param height The height of the maze in cells
+ * @return struct Maze* The new maze, NULL if the size is not positive or too large
+ */
+struct Maze *mazegen_init(int width, int height) {
+    if (width <= 0 || height <= 0 || INT_MAX / width < height)
+        return NULL;
+
+    return init_maze(width, height);
+}
+
+/**
+ * @brief Reads a maze from a bmp file made by this program,
+ * it has to be freed with mazegen_free
+ * 
+ * @param path Path to the bmp file
+ * @param block_size If not NULL the block size of the picture is stored in it
+ * @return struct Maze* The maze, NULL if the file could not be read or is not a maze
+ */
+struct Maze *mazegen_load_bmp(const char *path, int *block_size) {
+    BMPFile bmp;
+    if (open_bmp_file(path, &bmp) != BMP_NO_ERROR)
+        return NULL;
+
+    Maze *m = maze_from_bmp(&bmp, block_size);
+    close_bmp_file(&bmp);
+
+    return m;
+}
+
+/**
+ * @brief Generates a new maze in place, the previous walls are discarded
+ * 
+ * @param m The maze
+ * @param start_x The x coordinate of the cell the generation starts from
+ * @param start_y The y coordinate of the cell the generation starts from
+ * @return int 0 on success, -1 if the start is outside of the maze
+ */
+int mazegen_generate(struct Maze *m, int start_x, int start_y) {
+    if (is_in_maze(m, start_x, start_y) == false)
+        return -1;
+
+    clear_maze(m);
+    generate_maze(m, start_x, start_y);
+
+    return 0;
+}
+
+int mazegen_width(const struct Maze *m) {
+    return m->width;
+}
+
+int mazegen_height(const struct Maze *m) {
+    return m->height;
+}
+
+/**
+ * @brief Returns the cells of the maze as one block of height * width cells in row-major order.
+ * Every cell is mazegen_cell_size() bytes, and the walls of it are one byte each
+ * in the order top, left, right, bottom starting at mazegen_walls_offset().
+ * 
+ * @param m The maze
+ * @return unsigned char* The cells, valid until the maze is freed
+ */
+unsigned char *mazegen_cells(struct Maze *m) {
+    return (unsigned char *)m->cells[0];
+}
+
+int mazegen_cell_size(void) {
+    return sizeof(Cell);
+}
+
+int mazegen_walls_offset(void) {
+    return offsetof(Cell, walls);
+}
+
+/**
+ * @brief Draws the maze into a new image, it has to be freed with mazegen_free_pixels.
+ * The size of it is given by mazegen_pixels_width and mazegen_pixels_height.
+ * 
+ * @param m The maze
+ * @param block_size The size of a square in the maze in pixels
+ * @return struct MazegenPixels* The image, NULL if the block size is not positive
+ * or the image would be too large for a bmp file
+ */
+struct MazegenPixels *mazegen_render(const struct Maze *m, int block_size) {
+    if (block_size <= 0 ||
+        INT_MAX / block_size < 2 * m->width + 1 ||
+        INT_MAX / block_size < 2 * m->height + 1)
+        return NULL;
+
+    int width = get_maze_width_in_pixels(m->width, block_size),
+        height = get_maze_height_in_pixels(m->height, block_size);
+    // the bmp header stores the size of the pixel array in an int
+    if (INT_MAX / 4 / width < height)
+        return NULL;
+
+    MazegenPixels *pixels = malloc(sizeof(MazegenPixels));
+    check_malloc(pixels);
+    pixels->pixels = gen_pixel_arr_from_maze(m, block_size);
+    pixels->width = width;
+    pixels->height = height;
+
+    return pixels;
+}
+
+int mazegen_pixels_width(const struct MazegenPixels *pixels) {
+    return pixels->width;
+}
+
+int mazegen_pixels_height(const struct MazegenPixels *pixels) {
+    return pixels->height;
+}
+
+/**
+ * @brief Returns the pixels as one block of rows from top to bottom,
+ * every pixel is 4 bytes in the order red, green, blue, alpha
+ * 
+ * @param pixels The image returned by mazegen_render
+ * @return unsigned char* The pixels, valid until the image is freed
+ */
+unsigned char *mazegen_pixel_data(struct MazegenPixels *pixels) {
+    return (unsigned char *)pixels->pixels[0];
+}
+
+/**
+ * @brief Writes the image into a bmp file
+ * 
+ * @param pixels The image returned by mazegen_render
+ * @param path Path to the bmp file
+ * @return int 0 on success, -1 if the file could not be opened
+ */
+int mazegen_save_bmp(const struct MazegenPixels *pixels, const char *path) {
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+        return -1;
+
+    create_image_from_pixels(fp, pixels->pixels, pixels->width, pixels->height);
+    fclose(fp);
+
+    return 0;
+}
+
+/**
+ * @brief Finds the shortest path between two cells, see solve_maze
+ * 
+ * @param path Has to hold width * height ints, the cells of the path are stored in it as y * width + x
+ * @return int The number of cells in the path, 0 if end can not be reached,
+ * -1 if start or end is outside of the maze
+ */
+int mazegen_solve(const struct Maze *m, int start_x, int start_y, int end_x, int end_y, int *path) {
+    if (is_in_maze(m, start_x, start_y) == false || is_in_maze(m, end_x, end_y) == false)
+        return -1;
+
+    return solve_maze(m, start_x, start_y, end_x, end_y, path);
+}
+
+void mazegen_free_pixels(struct MazegenPixels *pixels) {
+    free_pixel_array(pixels->pixels);
+    free(pixels);
+}
+
+void mazegen_free(struct Maze *m) {
+    free_maze(m);
+}
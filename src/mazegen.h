@@ -0,0 +1,53 @@
+#ifndef MAZEGEN_H
+#define MAZEGEN_H
+
+/*
+ * The C ABI of libmazegen.so. Only the functions in this header are exported
+ * and the structs are only passed around as pointers, so the layout of them
+ * can change without breaking the users of the library.
+ */
+
+#define MAZEGEN_ABI_VERSION 2
+
+#define MAZEGEN_API __attribute__((visibility("default")))
+
+struct Maze;
+struct MazegenPixels;
+
+MAZEGEN_API int mazegen_abi_version(void);
+
+MAZEGEN_API void mazegen_seed(unsigned int seed);
+
+MAZEGEN_API struct Maze *mazegen_init(int width, int height);
+
+MAZEGEN_API struct Maze *mazegen_load_bmp(const char *path, int *block_size);
+
+MAZEGEN_API int mazegen_generate(struct Maze *m, int start_x, int start_y);
+
+MAZEGEN_API int mazegen_width(const struct Maze *m);
+
+MAZEGEN_API int mazegen_height(const struct Maze *m);
+
+MAZEGEN_API unsigned char *mazegen_cells(struct Maze *m);
+
+MAZEGEN_API int mazegen_cell_size(void);
+
+MAZEGEN_API int mazegen_walls_offset(void);
+
+MAZEGEN_API struct MazegenPixels *mazegen_render(const struct Maze *m, int block_size);
+
+MAZEGEN_API int mazegen_pixels_width(const struct MazegenPixels *pixels);
+
+MAZEGEN_API int mazegen_pixels_height(const struct MazegenPixels *pixels);
+
+MAZEGEN_API unsigned char *mazegen_pixel_data(struct MazegenPixels *pixels);
+
+MAZEGEN_API int mazegen_save_bmp(const struct MazegenPixels *pixels, const char *path);
+
+MAZEGEN_API int mazegen_solve(const struct Maze *m, int start_x, int start_y, int end_x, int end_y, int *path);
+
+MAZEGEN_API void mazegen_free_pixels(struct MazegenPixels *pixels);
+
+MAZEGEN_API void mazegen_free(struct Maze *m);
+
+#endif
@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "pipeline.h"
+#include "bmp.h"
+#include "maze.h"
+#include "util.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Band {
+    unsigned char *bytes;
+    size_t size; /* The number of bytes used in this band */
+} Band;
+
+typedef struct Pipeline {
+    FILE *fp;
+    Band bands[PIPELINE_BAND_COUNT];
+    int head;   /* The next band to render */
+    int tail;   /* The next band to write */
+    int filled; /* The number of rendered bands waiting to be written */
+    bool done;  /* Set when there are no more bands to render */
+
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+
+    double write_time;
+} Pipeline;
+
+/**
+ * @brief Calculates how much of the shorter stage was hidden behind the longer one
+ * 
+ * @param stats The timings of the pipeline
+ * @return double 1 if rendering and writing overlapped completely, 0 if they ran in sequence
+ */
+double get_overlap_efficiency(const PipelineStats *stats) {
+    double shorter = stats->render_time < stats->write_time ? stats->render_time : stats->write_time;
+    if (shorter <= 0)
+        return 0;
+
+    double overlap = stats->render_time + stats->write_time - stats->total_time;
+    if (overlap < 0)
+        return 0;
+    if (shorter < overlap)
+        return 1;
+
+    return overlap / shorter;
+}
+
+/**
+ * @brief The writer thread, it writes the rendered bands to the file in order
+ * until the pipeline is done and every band has been written
+ * 
+ * @param arg The pipeline
+ * @return void* Always NULL
+ */
+static void *write_bands(void *arg) {
+    Pipeline *p = arg;
+
+    pthread_mutex_lock(&p->lock);
+    while (true) {
+        while (p->filled == 0 && p->done == false)
+            pthread_cond_wait(&p->not_empty, &p->lock);
+
+        if (p->filled == 0)
+            break;
+
+        Band *band = &p->bands[p->tail];
+        pthread_mutex_unlock(&p->lock);
+
+        double start = get_time();
+        fwrite(band->bytes, 1, band->size, p->fp);
+        p->write_time += get_time() - start;
+
+        pthread_mutex_lock(&p->lock);
+        p->tail = (p->tail + 1) % PIPELINE_BAND_COUNT;
+        p->filled--;
+        pthread_cond_signal(&p->not_full);
+    }
+    pthread_mutex_unlock(&p->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Renders the maze into bmp bytes and writes them to the file at the same time.
+ * The image is rendered in bands of scanlines into a ring of buffers, which a
+ * background thread drains into the file while the next bands are rendered.
+ * 
+ * @param fp Has to be a bmp file and the file has to be opened with "wb" flags
+ * @param m The maze to render
+ * @param block_size The size of a square in the maze in pixels
+ * @param stats If not NULL the timings of the pipeline are stored in it
+ */
+void create_image_from_maze_pipelined(FILE *fp, const Maze *m, int block_size, PipelineStats *stats) {
+    assert(block_size > 0);
+
+    int width = get_maze_width_in_pixels(m->width, block_size);
+    int height = get_maze_height_in_pixels(m->height, block_size);
+    int grid_height = 2 * m->height + 1;
+
+    BMPHeader h = {
+        .width = width,
+        .height = height,
+        .bytes_per_pixel = 4,
+    };
+    unsigned char header_bytes[BMP_HEADER_SIZE];
+    bmp_header_to_bytes(header_bytes, &h);
+
+    size_t scanline_size = (size_t)width * h.bytes_per_pixel;
+    size_t grid_row_size = scanline_size * block_size;
+    int rows_per_band = PIPELINE_BAND_SIZE / grid_row_size;
+    if (rows_per_band < 1)
+        rows_per_band = 1;
+
+    Pixel *line = malloc(width * sizeof(Pixel));
+    check_malloc(line);
+
+    Pipeline p = {.fp = fp, .head = 0, .tail = 0, .filled = 0, .done = false, .write_time = 0};
+    for (int i = 0; i < PIPELINE_BAND_COUNT; i++) {
+        p.bands[i].bytes = malloc(grid_row_size * rows_per_band);
+        check_malloc(p.bands[i].bytes);
+    }
+    pthread_mutex_init(&p.lock, NULL);
+    pthread_cond_init(&p.not_empty, NULL);
+    pthread_cond_init(&p.not_full, NULL);
+
+    double start = get_time();
+    double render_time = 0;
+
+    fwrite(header_bytes, 1, BMP_HEADER_SIZE, fp);
+
+    pthread_t writer;
+    if (pthread_create(&writer, NULL, write_bands, &p) != 0) {
+        fprintf(stderr, "ERROR: Could not start writer thread\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // bmp stores the rows bottom-up, so render from the last grid row
+    int grid_row = grid_height - 1;
+    while (grid_row >= 0) {
+        pthread_mutex_lock(&p.lock);
+        while (p.filled == PIPELINE_BAND_COUNT)
+            pthread_cond_wait(&p.not_full, &p.lock);
+        Band *band = &p.bands[p.head];
+        pthread_mutex_unlock(&p.lock);
+
+        double render_start = get_time();
+        band->size = 0;
+        for (int i = 0; i < rows_per_band && grid_row >= 0; i++, grid_row--) {
+            unsigned char *first = band->bytes + band->size;
+            gen_pixel_row_from_maze(m, grid_row, block_size, line);
+            pixel_line_to_bytes(first, line, width);
+
+            // every scanline of a grid row is the same
+            for (int j = 1; j < block_size; j++)
+                memcpy(first + j * scanline_size, first, scanline_size);
+            band->size += grid_row_size;
+        }
+        render_time += get_time() - render_start;
+
+        pthread_mutex_lock(&p.lock);
+        p.head = (p.head + 1) % PIPELINE_BAND_COUNT;
+        p.filled++;
+        pthread_cond_signal(&p.not_empty);
+        pthread_mutex_unlock(&p.lock);
+    }
+
+    pthread_mutex_lock(&p.lock);
+    p.done = true;
+    pthread_cond_signal(&p.not_empty);
+    pthread_mutex_unlock(&p.lock);
+
+    pthread_join(writer, NULL);
+
+    if (stats != NULL) {
+        stats->render_time = render_time;
+        stats->write_time = p.write_time;
+        stats->total_time = get_time() - start;
+    }
+
+    pthread_cond_destroy(&p.not_full);
+    pthread_cond_destroy(&p.not_empty);
+    pthread_mutex_destroy(&p.lock);
+    for (int i = 0; i < PIPELINE_BAND_COUNT; i++)
+        free(p.bands[i].bytes);
+    free(line);
+}
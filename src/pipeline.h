@@ -0,0 +1,25 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "maze.h"
+#include <stdio.h>
+
+#ifndef PIPELINE_BAND_COUNT
+#define PIPELINE_BAND_COUNT 4 /* The number of bands in the ring, at least 2 so one can be rendered while the other is written */
+#endif
+
+#ifndef PIPELINE_BAND_SIZE
+#define PIPELINE_BAND_SIZE (1 << 20) /* The preferred size of a band in bytes */
+#endif
+
+typedef struct PipelineStats {
+    double render_time; /* Seconds spent on rendering bands */
+    double write_time;  /* Seconds the writer thread spent on writing bands */
+    double total_time;  /* Seconds from the start of rendering until the last band was written */
+} PipelineStats;
+
+double get_overlap_efficiency(const PipelineStats *stats);
+
+void create_image_from_maze_pipelined(FILE *fp, const Maze *m, int block_size, PipelineStats *stats);
+
+#endif
@@ -0,0 +1,149 @@
+#include "svg.h"
+#include "maze.h"
+#include "util.h"
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Walls are described as segments between the corners of the cells, corner
+ * (x, y) is the top-left corner of cell (x, y). Consecutive walls on the same
+ * line are merged into one segment, so a long corridor is a single segment.
+ */
+
+typedef struct OutBuffer {
+    FILE *fp;
+    char *data;
+    size_t size;
+} OutBuffer;
+
+typedef void (*SegmentCallback)(OutBuffer *out, int x1, int y1, int x2, int y2);
+
+static void flush_out(OutBuffer *out) {
+    fwrite(out->data, 1, out->size, out->fp);
+    out->size = 0;
+}
+
+static void write_out(OutBuffer *out, const char *fmt, ...) {
+    // a single write is never longer than 256 bytes, so make sure that much is free
+    if (SVG_BUFFER_SIZE - out->size < 256)
+        flush_out(out);
+
+    va_list args;
+    va_start(args, fmt);
+    out->size += vsnprintf(out->data + out->size, SVG_BUFFER_SIZE - out->size, fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief Calls the callback for every merged wall segment of the maze.
+ * The rows are visited once from top to bottom, vertical segments are kept
+ * open in an array until they end, so it needs O(width) extra memory.
+ * 
+ * @param m The maze
+ * @param out Passed on to the callback
+ * @param callback Called with the two end corners of each segment
+ */
+static void for_each_wall_segment(const Maze *m, OutBuffer *out, SegmentCallback callback) {
+    int *run_start = malloc((m->width + 1) * sizeof(int)); /* The first corner of the open vertical segment of each column, -1 if none */
+    check_malloc(run_start);
+    for (int x = 0; x <= m->width; x++)
+        run_start[x] = -1;
+
+    for (int y = 0; y <= m->height; y++) {
+        // horizontal walls on the top of row y, the cell below is drawn last if there is one
+        int start = -1;
+        for (int x = 0; x <= m->width; x++) {
+            bool is_wall = x < m->width &&
+                           (y < m->height ? m->cells[y][x].walls[TOP]
+                                          : m->cells[y - 1][x].walls[BOTTOM]);
+            if (is_wall && start == -1) {
+                start = x;
+            } else if (is_wall == false && start != -1) {
+                callback(out, start, y, x, y);
+                start = -1;
+            }
+        }
+
+        // vertical walls on the left of each cell in row y, the cell on the right is drawn last if there is one
+        for (int x = 0; x <= m->width; x++) {
+            bool is_wall = y < m->height &&
+                           (x < m->width ? m->cells[y][x].walls[LEFT]
+                                         : m->cells[y][x - 1].walls[RIGHT]);
+            if (is_wall && run_start[x] == -1) {
+                run_start[x] = y;
+            } else if (is_wall == false && run_start[x] != -1) {
+                callback(out, x, run_start[x], x, y);
+                run_start[x] = -1;
+            }
+        }
+    }
+
+    free(run_start);
+}
+
+static void write_svg_segment(OutBuffer *out, int x1, int y1, int x2, int y2) {
+    // one cell is 2 units wide in the picture, the walls are 1 unit thick
+    if (y1 == y2)
+        write_out(out, "M%d %dH%d", 2 * x1, 2 * y1, 2 * x2);
+    else
+        write_out(out, "M%d %dV%d", 2 * x1, 2 * y1, 2 * y2);
+}
+
+static void write_line_segment(OutBuffer *out, int x1, int y1, int x2, int y2) {
+    write_out(out, "%d %d %d %d\n", x1, y1, x2, y2);
+}
+
+/**
+ * @brief Write the walls of the maze to an svg file as one path,
+ * it looks the same as the bmp output with the same block size
+ * 
+ * @param fp Has to be opened with "w" or "wb" flags
+ * @param m The maze
+ * @param block_size The size of a square in the maze in pixels
+ */
+void create_svg_from_maze(FILE *fp, const Maze *m, int block_size) {
+    assert(block_size > 0);
+
+    OutBuffer out = {.fp = fp, .size = 0};
+    out.data = malloc(SVG_BUFFER_SIZE);
+    check_malloc(out.data);
+
+    int width = 2 * m->width + 1, height = 2 * m->height + 1;
+
+    write_out(&out, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" shape-rendering=\"crispEdges\">\n",
+              get_maze_width_in_pixels(m->width, block_size),
+              get_maze_height_in_pixels(m->height, block_size),
+              width, height);
+    write_out(&out, "<rect width=\"%d\" height=\"%d\" fill=\"white\"/>\n", width, height);
+    // the segments go through the middle of the wall squares
+    write_out(&out, "<path transform=\"translate(0.5 0.5)\" stroke=\"black\" stroke-width=\"1\" stroke-linecap=\"square\" fill=\"none\" d=\"");
+
+    for_each_wall_segment(m, &out, write_svg_segment);
+
+    write_out(&out, "\"/>\n</svg>\n");
+    flush_out(&out);
+
+    free(out.data);
+}
+
+/**
+ * @brief Write the walls of the maze as a list of segments, one per line
+ * in the form of "x1 y1 x2 y2", where (x, y) is the top-left corner of cell (x, y)
+ * 
+ * @param fp Has to be opened with "w" or "wb" flags
+ * @param m The maze
+ */
+void create_lines_from_maze(FILE *fp, const Maze *m) {
+    OutBuffer out = {.fp = fp, .size = 0};
+    out.data = malloc(SVG_BUFFER_SIZE);
+    check_malloc(out.data);
+
+    for_each_wall_segment(m, &out, write_line_segment);
+    flush_out(&out);
+
+    free(out.data);
+}
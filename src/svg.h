@@ -0,0 +1,15 @@
+#ifndef SVG_H
+#define SVG_H
+
+#include "maze.h"
+#include <stdio.h>
+
+#ifndef SVG_BUFFER_SIZE
+#define SVG_BUFFER_SIZE (1 << 20) /* The size of the output buffer in bytes */
+#endif
+
+void create_svg_from_maze(FILE *fp, const Maze *m, int block_size);
+
+void create_lines_from_maze(FILE *fp, const Maze *m);
+
+#endif
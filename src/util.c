@@ -1,6 +1,9 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "util.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 int clamp(int val, int min, int max) {
     if (val < min)
@@ -27,3 +30,15 @@ void check_malloc(void *ptr) {
         exit(EXIT_FAILURE);
     }
 }
+
+/**
+ * @brief Returns the time of a monotonic clock, unlike clock() it measures
+ * wall time so it is not affected by the number of running threads
+ * 
+ * @return double The current time in seconds
+ */
+double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
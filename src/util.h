@@ -7,4 +7,6 @@ void shuffle(int *arr, int size);
 
 void check_malloc(void *ptr);
 
+double get_time(void);
+
 #endif
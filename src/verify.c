@@ -0,0 +1,171 @@
+#include "verify.h"
+#include "maze.h"
+#include "util.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The maze is checked one row at a time with a union-find which only holds
+ * the previous and the current row. Slot (y % 2) * width + x belongs to cell
+ * (x, y). After a row is done its sets are rewritten to point inside the row,
+ * so the slots of the previous row can be reused by the next one.
+ */
+
+static int find_set(int *parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/**
+ * @brief Adds a passage between two cells
+ * 
+ * @return true The two cells were in different sets
+ * @return false The two cells were already connected, so the passage closes a loop
+ */
+static bool union_sets(int *parent, int a, int b) {
+    a = find_set(parent, a);
+    b = find_set(parent, b);
+    if (a == b)
+        return false;
+
+    parent[a] = b;
+    return true;
+}
+
+/**
+ * @brief Checks that the maze is perfect: the walls between neighbours agree,
+ * the edge of the maze is closed, every cell is reachable and there are no loops.
+ * It makes a single pass over the rows and uses O(width) extra memory.
+ * 
+ * @param m The maze to check
+ * @param v Where the findings are stored
+ * @return true The maze is perfect
+ * @return false The maze has at least one problem, see v for the details
+ */
+bool verify_maze(const Maze *m, MazeVerification *v) {
+    int w = m->width;
+
+    int *parent = malloc(2 * w * sizeof(int));
+    check_malloc(parent);
+    int *first = malloc(2 * w * sizeof(int)); /* The first slot of the current row in the set, by root */
+    check_malloc(first);
+    bool *seen = malloc(2 * w * sizeof(bool)); /* The sets which are still part of the current row, by root */
+    check_malloc(seen);
+    int *label = malloc(w * sizeof(int)); /* The set of each cell in the current row */
+    check_malloc(label);
+
+    *v = (MazeVerification){.cells = (long)w * m->height};
+    long closed_components = 0;
+
+    for (int y = 0; y < m->height; y++) {
+        int cur = (y % 2) * w, prev = ((y + 1) % 2) * w;
+        const Cell *row = m->cells[y];
+
+        for (int x = 0; x < w; x++)
+            parent[cur + x] = cur + x;
+
+        for (int x = 0; x < w; x++) {
+            // boundary walls
+            if (y == 0 && row[x].walls[TOP] == false)
+                v->open_boundaries++;
+            if (y == m->height - 1 && row[x].walls[BOTTOM] == false)
+                v->open_boundaries++;
+            if (x == 0 && row[x].walls[LEFT] == false)
+                v->open_boundaries++;
+            if (x == w - 1 && row[x].walls[RIGHT] == false)
+                v->open_boundaries++;
+
+            // passage to the left neighbour
+            if (0 < x) {
+                if (row[x - 1].walls[RIGHT] != row[x].walls[LEFT])
+                    v->asymmetric_walls++;
+
+                if (row[x].walls[LEFT] == false) {
+                    v->edges++;
+                    if (union_sets(parent, cur + x - 1, cur + x) == false)
+                        v->cycles++;
+                }
+            }
+
+            // passage to the neighbour above
+            if (0 < y) {
+                if (m->cells[y - 1][x].walls[BOTTOM] != row[x].walls[TOP])
+                    v->asymmetric_walls++;
+
+                if (row[x].walls[TOP] == false) {
+                    v->edges++;
+                    if (union_sets(parent, prev + x, cur + x) == false)
+                        v->cycles++;
+                }
+            }
+        }
+
+        for (int i = 0; i < 2 * w; i++) {
+            seen[i] = false;
+            first[i] = -1;
+        }
+
+        // a set of the previous row which did not reach this row is finished
+        for (int x = 0; x < w; x++) {
+            label[x] = find_set(parent, cur + x);
+            seen[label[x]] = true;
+        }
+        for (int x = 0; 0 < y && x < w; x++) {
+            int root = find_set(parent, prev + x);
+            if (seen[root] == false) {
+                seen[root] = true;
+                closed_components++;
+            }
+        }
+
+        // move every set of this row inside the row
+        for (int x = 0; x < w; x++) {
+            if (first[label[x]] == -1)
+                first[label[x]] = cur + x;
+            label[x] = first[label[x]];
+        }
+        for (int x = 0; x < w; x++)
+            parent[cur + x] = label[x];
+    }
+
+    int last = ((m->height - 1) % 2) * w;
+    long open_components = 0;
+    for (int x = 0; x < w; x++) {
+        if (parent[last + x] == last + x)
+            open_components++;
+    }
+    v->components = closed_components + open_components;
+
+    free(label);
+    free(seen);
+    free(first);
+    free(parent);
+
+    return v->asymmetric_walls == 0 &&
+           v->open_boundaries == 0 &&
+           v->components == 1 &&
+           v->cycles == 0 &&
+           v->edges == v->cells - 1;
+}
+
+/**
+ * @brief Prints the findings of verify_maze
+ * 
+ * @param out The stream to output the findings in
+ * @param v The findings
+ */
+void print_maze_verification(FILE *out, const MazeVerification *v) {
+    fprintf(out, "cells: %ld, edges: %ld (expected %ld), components: %ld, cycles: %ld, asymmetric walls: %ld, open boundary walls: %ld\n",
+            v->cells,
+            v->edges,
+            v->cells - 1,
+            v->components,
+            v->cycles,
+            v->asymmetric_walls,
+            v->open_boundaries);
+}
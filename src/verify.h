@@ -0,0 +1,21 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include "maze.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+typedef struct MazeVerification {
+    long cells;            /* The number of cells in the maze */
+    long edges;            /* The number of passages between neighbouring cells */
+    long components;       /* The number of connected groups of cells */
+    long cycles;           /* The number of passages which close a loop */
+    long asymmetric_walls; /* The number of walls which only one of the two cells has */
+    long open_boundaries;  /* The number of missing walls on the edge of the maze */
+} MazeVerification;
+
+bool verify_maze(const Maze *m, MazeVerification *v);
+
+void print_maze_verification(FILE *out, const MazeVerification *v);
+
+#endif